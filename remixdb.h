@@ -15,6 +15,7 @@ extern "C" {
 struct xdb;
 struct xdb_ref;
 struct xdb_iter;
+struct xdb_batch;
 
   extern struct xdb *
 remixdb_open(const char * const dir, const size_t cache_size_mb, const size_t mt_size_mb);
@@ -38,6 +39,25 @@ remixdb_set(struct xdb_ref * const ref, const void * const kbuf, const uint32_t
   extern bool
 remixdb_del(struct xdb_ref * const ref, const void * const kbuf, const uint32_t klen);
 
+  extern struct xdb_batch *
+remixdb_batch_create(void);
+
+  extern bool
+remixdb_batch_put(struct xdb_batch * const batch, const void * const kbuf, const uint32_t klen,
+    const void * const vbuf, const uint32_t vlen);
+
+  extern bool
+remixdb_batch_del(struct xdb_batch * const batch, const void * const kbuf, const uint32_t klen);
+
+  extern void
+remixdb_batch_clear(struct xdb_batch * const batch);
+
+  extern void
+remixdb_batch_destroy(struct xdb_batch * const batch);
+
+  extern bool
+remixdb_write_batch(struct xdb_ref * const ref, struct xdb_batch * const batch);
+
   extern bool
 remixdb_probe(struct xdb_ref * const ref, const void * const kbuf, const uint32_t klen);
 
@@ -3017,6 +3017,61 @@ wormhole_merge(struct wormref * const ref, const struct kref * const kref,
   return rsi;
 }
 
+  // 批量合并：krefs 必须按键升序排列且不含重复键
+  // 落在同一个叶子节点中的连续键只跳转和加锁一次；叶子已满时退回到 wormhole_merge() 分裂插入
+  // uf 按 krefs 的顺序对每个键恰好调用一次 (持有叶子写锁)
+  bool
+wormhole_merge_sorted(struct wormref * const ref, const struct kref * const krefs, const u32 nr,
+    kv_merge_func uf, void * const priv)
+{
+  struct wormhole * const map = ref->map;
+  u32 i = 0;
+  while (i < nr) {
+    struct wormleaf * const leaf = wormhole_jump_leaf_write(ref, &krefs[i]); // 跳转并加写锁
+    bool full = false;
+    do {
+      const struct kref * const kref = &krefs[i];
+      const u32 im = wormleaf_match_hs(leaf, kref); // 查找
+      if (im < WH_KPN) { // 更新
+        struct kv * const kv0 = wormleaf_kv_at_ih(leaf, im);
+        struct kv * const kv = uf(kv0, priv);
+        if ((kv != kv0) && (kv != NULL)) {
+          struct kv * const new = map->mm.in(kv, map->mm.priv);
+          if (unlikely(new == NULL)) {
+            wormleaf_unlock_write(leaf);
+            return false;
+          }
+          struct kv * const old = wormleaf_update(leaf, im, new);
+          map->mm.free(old, map->mm.priv);
+        }
+      } else if (leaf->nr_keys < WH_KPN) { // 插入 (叶子未满)
+        struct kv * const kv = uf(NULL, priv);
+        if (kv) {
+          struct kv * const new = map->mm.in(kv, map->mm.priv);
+          if (unlikely(new == NULL)) {
+            wormleaf_unlock_write(leaf);
+            return false;
+          }
+          wormleaf_insert(leaf, new);
+        }
+      } else { // 叶子已满，需要分裂
+        full = true;
+        break;
+      }
+      i++;
+      // 持有叶子锁时叶子的右边界 (next->anchor) 不会改变
+    } while ((i < nr) && ((leaf->next == NULL) || (kref_kv_compare(&krefs[i], leaf->next->anchor) < 0)));
+    wormleaf_unlock_write(leaf);
+
+    if (full) {
+      if (!wormhole_merge(ref, &krefs[i], uf, priv))
+        return false;
+      i++;
+    }
+  }
+  return true;
+}
+
   // 线程安全的merge
   bool
 whsafe_merge(struct wormref * const ref, const struct kref * const kref,
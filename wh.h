@@ -90,6 +90,13 @@ wormhole_put(struct wormref * const ref, struct kv * const kv);
 wormhole_merge(struct wormref * const ref, const struct kref * const kref,
     kv_merge_func uf, void * const priv);
 
+// 批量合并操作：krefs 按键升序排列且不含重复键，同一叶子中的连续键只加锁一次
+// 参数: ref - WormHole 引用, krefs - 有序键数组, nr - 键数量, uf - 合并函数 (按顺序对每个键调用一次), priv - 用户数据
+// 返回: 成功时返回 true，失败时返回 false
+  extern bool
+wormhole_merge_sorted(struct wormref * const ref, const struct kref * const krefs, const u32 nr,
+    kv_merge_func uf, void * const priv);
+
 // 就地处理 (读取模式) - 对现有键值对执行只读操作
 // 参数: ref - WormHole 引用, key - 键, uf - 处理函数, priv - 用户数据
 // 返回: 成功时返回 true，失败时返回 false
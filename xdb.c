@@ -16,6 +16,9 @@
 #define XDB_COMP_CONC ((4)) // 最大压缩线程数
 #define XDB_REJECT_SIZE_SHIFT ((4)) // 拒绝大小移位 (用于计算最大拒绝大小，例如 1/16)
 #define WAL_BLKSZ ((PGSZ << 6)) // WAL 块大小 (通常 PGSZ 是 4KB, 所以这里是 256KB)
+#define WAL_SEALED ((1lu << 63)) // wal.rsv 的封闭标记：置位时写者不能在当前缓冲区预留空间
+#define WAL_BATCH ((1lu << 62)) // wal.rsv 的批量写入标记：封闭者需要获取叶节点锁，写者必须放弃预留并重试
+#define WAL_VLEN_BATCH ((0x20000u)) // WAL 批量记录头的 vlen 标记 (高于 SST_VLEN_TS)
 // }}} defs // 定义区域结束
 
 // struct {{{ // 结构体定义区域开始
@@ -33,12 +36,18 @@ struct mt_pair {
 };
 
 // 预写日志 (Write-Ahead Log) 结构体
+// 组提交 (group commit)：写者无锁地在共享缓冲区中预留空间并各自拷贝记录；
+// 缓冲区满时由一个写者 (leader) 持锁封闭缓冲区，等待其他写者拷贝完成后整块提交给 wring
 struct wal {
+  au64 rsv;           // 无锁预留字：低位为缓冲区内下一个空闲偏移，WAL_SEALED 位表示缓冲区已封闭
+  u64 padding1[7];    // 缓存行填充
+  au64 done;          // 当前缓冲区中已完成拷贝的字节数 (含头部)
+  u64 padding2[7];    // 缓存行填充
+  au64 write_user;    // 用户写入字节数统计 (追加时更新)
   u8 * buf;           // 当前写入的缓冲区 (通过 wring_acquire() 获取)
-  u64 bufoff;         // 缓冲区内当前的偏移量 (字节)
+  u64 bufoff;         // 缓冲区内当前的偏移量 (字节)；仅在封闭期间 (持有锁) 有效
   u64 woff;           // 文件中的写入偏移量 (PGSZ 的倍数)
   u64 soff;           // 上次同步的文件偏移量
-  u64 write_user;     // 用户写入字节数统计 (追加时更新)
   u64 write_nbytes;   // 实际写入 WAL 文件字节数统计 (追加时更新)
   u64 version;        // WAL 版本号 (压缩时改变)
 
@@ -54,7 +63,8 @@ struct xdb {
   struct mt_pair * volatile mt_view; // 指向当前活动的内存表视图 (mt_pair)
   u64 padding1[7];                  // 缓存行填充
 
-  u64 mtsz;                         // 当前内存表大小 (写者频繁更改)
+  au64 mtsz;                        // 当前内存表大小 (写者频繁更改，原子更新)
+  u64 padding4[7];                  // 缓存行填充
   struct wal wal;                   // WAL 结构体 (写者频繁更改)
   // 非频繁访问成员
   void * mt1;                       // 内存表实例 1
@@ -76,7 +86,7 @@ struct xdb {
   bool padding2[2];                 // 填充
 
   u64 padding3[7];                  // 缓存行填充
-  spinlock lock;                    // 用于保护共享数据的自旋锁
+  spinlock lock;                    // 保护 WAL 刷新/切换的自旋锁 (写者仅在缓冲区满时获取)
 };
 
 // XDB 数据库引用结构体 (每个线程持有一个)
@@ -106,6 +116,16 @@ struct xdb_iter {
   struct miter * miter;             // 多路归并迭代器
   struct coq * coq_parked;          // 停放的协程队列 (用于迭代器 park/resume)
 };
+// 批量写入对象：按插入顺序保存 KV，并预先编码好它们的 WAL 记录
+struct xdb_batch {
+  u32 nr;           // KV 数量
+  u32 cap;          // kvs 数组容量
+  struct kv ** kvs; // 按插入顺序保存的 KV (由批量写入对象持有)
+  u8 * wbuf;        // 预先编码的 WAL 记录 (批量记录体)
+  u64 wsize;        // wbuf 已使用的字节数
+  u64 wcap;         // wbuf 容量
+};
+
 // }}} struct // 结构体定义区域结束
 
 // misc {{{ // 杂项函数区域开始
@@ -135,12 +155,12 @@ xdb_mt_wal_full(struct xdb * const xdb)
 {
   // 内存表已满 或 WAL 已满
   // 当此条件为真时：写者必须等待；压缩应该开始
-  return (xdb->mtsz >= xdb->max_mtsz) || (xdb->wal.woff >= xdb->wal.maxsz);
+  return (atomic_load_explicit(&xdb->mtsz, MO_RELAXED) >= xdb->max_mtsz) || (xdb->wal.woff >= xdb->wal.maxsz);
 }
 // }}} misc // 杂项函数区域结束
 
 // wal {{{ // WAL 相关函数区域开始
-// 将 WAL 缓冲区刷新到磁盘 (持有锁时调用)
+// 将 WAL 缓冲区刷新到磁盘 (持有锁且缓冲区已封闭时调用)
   static void
 wal_flush(struct wal * const wal)
 {
@@ -165,7 +185,7 @@ wal_flush(struct wal * const wal)
   }
 }
 
-// 刷新 WAL 缓冲区并同步到磁盘 (必须持有锁时调用)
+// 刷新 WAL 缓冲区并同步到磁盘 (必须持有锁且缓冲区已封闭时调用)
   static void
 wal_flush_sync(struct wal * const wal)
 {
@@ -193,23 +213,78 @@ wal_flush_sync_wait(struct wal * const wal)
   wal_io_complete(wal);
 }
 
-// 向 WAL 追加一条 KV 记录 (必须在持有 xdb->lock 时调用)
+// 封闭当前缓冲区 (必须在持有 xdb->lock 时调用)；flags 为 WAL_SEALED，批量写入时另加 WAL_BATCH
+// 阻止新的预留，并等待已预留空间的写者完成拷贝；之后 wal->bufoff 有效
   static void
-wal_append(struct wal * const wal, const struct kv * const kv)
+wal_seal(struct wal * const wal, const u64 flags)
 {
-  debug_assert(kv);
-  // 估计 KV 记录在 WAL 中的大小 (包括 CRC32C校验和)
-  const size_t estsz = sst_kv_vi128_estimate(kv) + sizeof(u32);
-  if ((estsz + wal->bufoff) > WAL_BLKSZ) // 如果当前缓冲区不足以容纳新记录
-    wal_flush(wal); // 刷新当前缓冲区
+  const u64 r = atomic_fetch_or_explicit(&wal->rsv, flags, MO_ACQ_REL);
+  debug_assert((r & WAL_SEALED) == 0);
+  while (atomic_load_explicit(&wal->done, MO_ACQUIRE) != r)
+    cpu_pause();
+  wal->bufoff = r;
+}
 
-  debug_assert(wal->buf);
-  // 将 KV 记录编码到缓冲区
-  u8 * const ptr = sst_kv_vi128_encode(wal->buf + wal->bufoff, kv);
-  // 在值的后面写入键的 CRC 校验和
-  *(u32 *)ptr = kv->hashlo;
-  wal->bufoff += estsz; // 更新缓冲区偏移
+// 向已封闭的缓冲区追加任意长度的数据 (必须在持有 xdb->lock 且缓冲区已封闭时调用)
+// 写满的缓冲区正好是页对齐的，因此数据在文件中是连续的 (中间没有填充零)
+  static void
+wal_append_raw(struct wal * const wal, const u8 * ptr, u64 size)
+{
+  while (size) {
+    if (wal->bufoff == WAL_BLKSZ)
+      wal_flush(wal);
+    const u64 n = ((WAL_BLKSZ - wal->bufoff) < size) ? (WAL_BLKSZ - wal->bufoff) : size;
+    memcpy(wal->buf + wal->bufoff, ptr, n);
+    wal->bufoff += n;
+    ptr += n;
+    size -= n;
+  }
+}
+
+// 重新开放缓冲区供写者预留 (必须在持有 xdb->lock 时调用)
+  static void
+wal_unseal(struct wal * const wal)
+{
   debug_assert(wal->bufoff <= WAL_BLKSZ);
+  atomic_store_explicit(&wal->done, wal->bufoff, MO_RELAXED);
+  // release: 新的 buf 和 done 必须先于新的预留字可见
+  atomic_store_explicit(&wal->rsv, wal->bufoff, MO_RELEASE);
+}
+
+// 尝试在当前缓冲区中无锁预留 estsz 字节
+// 成功时返回预留的偏移；缓冲区已封闭或空间不足时返回 UINT64_MAX
+  static inline u64
+wal_try_reserve(struct wal * const wal, const u64 estsz)
+{
+  u64 r = atomic_load_explicit(&wal->rsv, MO_ACQUIRE);
+  while (((r & WAL_SEALED) == 0) && ((r + estsz) <= WAL_BLKSZ)) {
+    if (atomic_compare_exchange_weak_explicit(&wal->rsv, &r, r + estsz, MO_ACQUIRE, MO_ACQUIRE))
+      return r;
+  }
+  return UINT64_MAX;
+}
+
+// 将 KV 记录编码到已预留的空间
+  static inline void
+wal_encode(u8 * const ptr, const struct kv * const kv)
+{
+  u8 * const end = sst_kv_vi128_encode(ptr, kv);
+  // 在值的后面写入键的 CRC 校验和
+  *(u32 *)end = kv->hashlo;
+}
+
+// 提交已预留的空间 (拷贝完成)；提交后缓冲区可能随时被 leader 写出
+  static inline void
+wal_commit(struct wal * const wal, const u64 estsz)
+{
+  atomic_fetch_add_explicit(&wal->done, estsz, MO_RELEASE);
+}
+
+// 估计 KV 记录在 WAL 中的大小 (包括键的 CRC32C 校验和)
+  static inline u64
+wal_kv_estimate(const struct kv * const kv)
+{
+  return sst_kv_vi128_estimate(kv) + sizeof(u32);
 }
 
 // 打开 WAL 文件
@@ -245,6 +320,9 @@ wal_open(struct wal * const wal, const char * const path)
   if (!wal->buf)
     goto fail_buf;
 
+  // 恢复完成之前保持封闭
+  atomic_store_explicit(&wal->rsv, WAL_SEALED, MO_RELAXED);
+
   free(fn); // 释放文件名缓冲区
   return true;
 
@@ -260,7 +338,7 @@ fail_open1: // fd1 打开失败处理
   return false;
 }
 
-// 切换 WAL 文件 (必须持有锁时调用)
+// 切换 WAL 文件 (必须持有锁且缓冲区已封闭时调用)
 // 返回旧 WAL 文件的大小
   static u64
 wal_switch(struct wal * const wal, const u64 version)
@@ -288,12 +366,62 @@ wal_switch(struct wal * const wal, const u64 version)
   static void
 wal_close(struct wal * const wal)
 {
+  if ((atomic_load_explicit(&wal->rsv, MO_ACQUIRE) & WAL_SEALED) == 0)
+    wal_seal(wal, WAL_SEALED); // 取回最终的 bufoff (此时已没有写者)
   wal_flush_sync_wait(wal); // 确保所有数据已写入并同步
   wring_destroy(wal->wring); // 销毁 wring (销毁操作会调用 wring_flush)
 
   close(wal->fds[0]); // 关闭文件描述符
   close(wal->fds[1]);
 }
+
+// 持有锁并封闭 WAL 缓冲区，获得对 WAL 的独占访问
+  static void
+xdb_wal_lock(struct xdb * const xdb)
+{
+  xdb_lock(xdb);
+  wal_seal(&xdb->wal, WAL_SEALED);
+}
+
+// 重新开放 WAL 缓冲区并解锁
+  static void
+xdb_wal_unlock(struct xdb * const xdb)
+{
+  wal_unseal(&xdb->wal);
+  xdb_unlock(xdb);
+}
+
+// 为 estsz 字节的记录预留 WAL 空间，返回预留空间的地址
+// 快速路径无锁；缓冲区满时由获得锁的线程 (leader) 封闭并写出整个缓冲区
+// 调用者写完记录后必须调用 wal_commit()
+// 返回 NULL 表示批量写入正在进行：调用者必须先释放持有的叶节点锁再重试，否则会与批量写入者死锁
+  static u8 *
+xdb_wal_reserve(struct xdb * const xdb, const u64 estsz)
+{
+  struct wal * const wal = &xdb->wal;
+  do {
+    const u64 off = wal_try_reserve(wal, estsz);
+    if (likely(off != UINT64_MAX))
+      return wal->buf + off;
+
+    // 慢路径：缓冲区空间不足，或者其他线程正在持锁写出 (封闭状态)
+    if (spinlock_trylock(&xdb->lock)) {
+      // 持锁时缓冲区总是开放的 (只有持锁者会封闭它)
+      const u64 r = atomic_load_explicit(&wal->rsv, MO_ACQUIRE);
+      if ((r + estsz) > WAL_BLKSZ) { // 其他 leader 可能已经写出过了
+        wal_seal(wal, WAL_SEALED);
+        wal_flush(wal);
+        wal_unseal(wal);
+      }
+      xdb_unlock(xdb);
+    } else if (atomic_load_explicit(&wal->rsv, MO_ACQUIRE) & WAL_BATCH) {
+      cpu_pause();
+      return NULL;
+    } else {
+      cpu_pause();
+    }
+  } while (true);
+}
 // }}} wal // WAL 相关函数区域结束
 
 // kv-alloc {{{ // KV 分配相关函数区域开始
@@ -422,6 +550,7 @@ xdb_unref(struct xdb_ref * const ref)
 struct xdb_reinsert_merge_ctx {
   struct kv * kv;   // 当前要重新插入的 KV 对象
   struct xdb * xdb; // XDB 主结构体指针
+  bool retry;       // 遇到批量写入，需要重试
 };
 
 // 用于重插入的合并函数 (kv_merge_func 的实现)
@@ -434,10 +563,16 @@ xdb_mt_reinsert_func(struct kv * const kv0, void * const priv)
     debug_assert(ret);
     const size_t incsz = sst_kv_size(ret); // 计算增加的大小
     struct xdb * const xdb = ctx->xdb;
-    xdb_lock(xdb); // 加锁保护共享数据
-    xdb->mtsz += incsz; // 更新内存表大小
-    wal_append(&xdb->wal, ret); // 将操作追加到 WAL
-    xdb_unlock(xdb); // 解锁
+    const u64 estsz = wal_kv_estimate(ret);
+    u8 * const ptr = xdb_wal_reserve(xdb, estsz);
+    if (ptr == NULL) { // 批量写入正在进行：释放叶节点锁后重试
+      free(ret);
+      ctx->retry = true;
+      return NULL;
+    }
+    wal_encode(ptr, ret); // 将操作追加到 WAL
+    atomic_fetch_add_explicit(&xdb->mtsz, incsz, MO_RELAXED); // 更新内存表大小
+    wal_commit(&xdb->wal, estsz);
     return ret; // 返回新插入的 KV 对象
   } else { // 如果 WMT 中已存在该键，则不覆盖 (重插入逻辑通常是针对 IMT 中未被 SST 接受的键)
     return kv0;
@@ -478,9 +613,12 @@ xdb_reinsert_rejected(struct xdb * const xdb, void * const wmt_map, void * const
         debug_die();
       ctx.kv = curr; // 设置上下文中的当前 KV
       // 将当前键合并到 WMT
-      bool s = kvmap_kv_merge(wmt_api, wmt_ref, curr, xdb_mt_reinsert_func, &ctx);
-      if (!s) // 合并失败则终止
-        debug_die();
+      do {
+        ctx.retry = false;
+        bool s = kvmap_kv_merge(wmt_api, wmt_ref, curr, xdb_mt_reinsert_func, &ctx);
+        if (!s) // 合并失败则终止
+          debug_die();
+      } while (ctx.retry);
     }
   }
   imt_api->iter_destroy(rej_iter); // 销毁 IMT 迭代器
@@ -491,7 +629,7 @@ xdb_reinsert_rejected(struct xdb * const xdb, void * const wmt_map, void * const
 
 // comp {{{ // 压缩逻辑区域开始
 // 压缩过程:
-//   -** 持有 xdb 锁
+//   -** 持有 xdb 锁并封闭 WAL 缓冲区 (等待已预留空间的写者完成)
 //       - 将内存表模式从 wmt-only 切换到 wmt+imt (非常快)
 //       - 同步刷新并切换日志文件
 //   -** 释放 xdb 锁
@@ -500,7 +638,7 @@ xdb_reinsert_rejected(struct xdb * const xdb, void * const wmt_map, void * const
 //   - 调用 msstz_comp 执行 SSTable 压缩
 //   - 释放 WAL 中的数据 (旧 WAL 中的数据已被处理)
 //   - 对于每个被拒绝的键，如果它仍然是最新的，则将其重新插入到 wmt 并追加到新的 WAL
-//       -** 对每个新的被拒绝键，持有/释放 xdb 锁
+//       -** 与普通写者一样无锁地预留 WAL 空间
 //   -** 持有 xdb 锁
 //       - 刷新新的 WAL 并发送异步 fsync (非阻塞)
 //   -** 释放 xdb 锁
@@ -517,7 +655,7 @@ xdb_reinsert_rejected(struct xdb * const xdb, void * const wmt_map, void * const
 xdb_do_comp(struct xdb * const xdb, const u64 max_rejsz)
 {
   const double t0 = time_sec(); // 记录开始时间
-  xdb_lock(xdb); // 加锁
+  xdb_wal_lock(xdb); // 加锁并封闭 WAL：已预留空间的写者全部完成后才会切换
 
   // 切换内存表视图 (mt_view)
   struct mt_pair * const v_comp = xdb->mt_view->next; // 获取下一个视图 (通常是 WMT+IMT 模式)
@@ -525,10 +663,10 @@ xdb_do_comp(struct xdb * const xdb, const u64 max_rejsz)
 
   // 切换日志文件
   const u64 walsz0 = wal_switch(&xdb->wal, msstz_version(xdb->z) + 1); // 切换 WAL，版本号与下一个 SSTable Zone 版本匹配
-  const u64 mtsz0 = xdb->mtsz; // 保存旧的内存表大小
-  xdb->mtsz = 0; // 在持有锁的情况下重置内存表大小 (新的 WMT 开始计数)
+  // 在封闭状态下重置内存表大小 (新的 WMT 开始计数)；旧视图的写者都已在提交前完成计数
+  const u64 mtsz0 = atomic_exchange_explicit(&xdb->mtsz, 0, MO_RELAXED);
 
-  xdb_unlock(xdb); // 解锁
+  xdb_wal_unlock(xdb); // 开放 WAL 并解锁
 
   void * const wmt_map = v_comp->wmt; // 当前的 WMT (在压缩视图中)
   void * const imt_map = v_comp->imt; // 当前的 IMT (即旧的 WMT，将被压缩)
@@ -547,9 +685,9 @@ xdb_do_comp(struct xdb * const xdb, const u64 max_rejsz)
   const double t_reinsert = time_sec(); // 记录重插入阶段结束时间
 
   // 刷新并同步新的 WAL：旧的 WAL 将被截断
-  xdb_lock(xdb);
+  xdb_wal_lock(xdb);
   wal_flush_sync(&xdb->wal);
-  xdb_unlock(xdb);
+  xdb_wal_unlock(xdb);
 
   free(anchors); // 释放锚点数组
   msstz_putv(xdb->z, oldv); // 归还旧的 SSTable 版本视图
@@ -574,7 +712,7 @@ xdb_do_comp(struct xdb * const xdb, const u64 max_rejsz)
   const double t_sync = time_sec(); // 记录同步截断操作结束时间
 
   // I/O 统计
-  const size_t usr_write = xdb->wal.write_user;         // 用户写入字节数
+  const size_t usr_write = atomic_load_explicit(&xdb->wal.write_user, MO_RELAXED); // 用户写入字节数
   const size_t wal_write = xdb->wal.write_nbytes;       // WAL 实际写入字节数
   const size_t sst_write = msstz_stat_writes(xdb->z);   // SSTable 写入字节数
   const size_t sst_read = msstz_stat_reads(xdb->z);     // SSTable 读取字节数 (逻辑读，可能远大于物理读)
@@ -720,6 +858,55 @@ xdb_recover_update_func(struct kv * const kv0, void * const priv)
   return ctx->newkv; // 返回新的 KV 对象 (覆盖旧的)
 }
 
+// 将解码的 WAL 记录插入到内存表
+  static void
+xdb_recover_kv(void * const wmt_ref, const struct wal_kv * const wal_kv, struct xdb_recover_merge_ctx * const ctx)
+{
+  struct kv * const kv = malloc(sizeof(struct kv) + wal_kv->kvlen); // 分配 KV 对象内存
+  debug_assert(kv);
+  kv->klen = wal_kv->kref.len;
+  kv->vlen = wal_kv->vlen;
+  kv->hash = kv_crc32c_extend(wal_kv->kref.hash32);
+  memcpy(kv->kv, wal_kv->kref.ptr, wal_kv->kvlen); // 复制键值数据
+  ctx->newkv = kv; // 设置上下文中的新 KV
+  // 合并到内存表
+  bool s = wmt_api->merge(wmt_ref, &wal_kv->kref, xdb_recover_update_func, ctx);
+  if (!s) // 合并失败则终止
+    debug_die();
+}
+
+// 恢复一个批量记录：记录体必须完整且校验和正确，否则整个批次都不恢复
+// 成功时返回记录体之后的位置；否则返回 NULL
+  static const u8 *
+xdb_recover_batch(void * const wmt_ref, const u8 * const body, const u8 * const end,
+    const struct wal_kv * const hdr, struct xdb_recover_merge_ctx * const ctx, u64 * const pnkeys)
+{
+  // 批量记录头的值: [记录体长度 u32][记录体的 crc32c u32]
+  if ((hdr->kref.len != sizeof(u64)) || ((hdr->vlen & SST_VLEN_MASK) != (sizeof(u32) * 2)))
+    return NULL;
+  const u8 * const val = hdr->kref.ptr + sizeof(u64);
+  const u32 bsz = ((const u32 *)val)[0];
+  const u32 bsum = ((const u32 *)val)[1];
+  if (((u64)(end - body) < bsz) || (kv_crc32c(body, bsz) != bsum)) // 残缺的批次 (写入时崩溃)
+    return NULL;
+
+  const u8 * const bend = body + bsz;
+  // 先完整解码一遍，确保不会只恢复一部分
+  for (const u8 * iter = body; iter < bend;) {
+    struct wal_kv wal_kv;
+    iter = wal_vi128_decode(iter, bend, &wal_kv);
+    if (!iter)
+      return NULL;
+  }
+  for (const u8 * iter = body; iter < bend;) {
+    struct wal_kv wal_kv;
+    iter = wal_vi128_decode(iter, bend, &wal_kv);
+    xdb_recover_kv(wmt_ref, &wal_kv, ctx);
+    (*pnkeys)++;
+  }
+  return bend;
+}
+
 // 从指定的 WAL 文件描述符恢复数据到内存表 (xdb->mt1)
 // 使用 xdb->mt1, xdb->mtsz, xdb->z (用于日志记录)
   static u64
@@ -738,7 +925,7 @@ xdb_recover_fd(struct xdb * const xdb, const int fd)
   const u8 * iter = mem + sizeof(u64); // 跳过文件开头的版本号
   const u8 * const end = mem + fsize; // 文件末尾指针
   u64 nkeys = 0; // 恢复的键计数
-  struct xdb_recover_merge_ctx ctx = {.mtsz = xdb->mtsz}; // 初始化恢复上下文
+  struct xdb_recover_merge_ctx ctx = {.mtsz = atomic_load_explicit(&xdb->mtsz, MO_RELAXED)}; // 初始化恢复上下文
 
   while ((iter < end) && ((*iter) == 0)) // 跳过头部的填充零
     iter++;
@@ -750,27 +937,22 @@ xdb_recover_fd(struct xdb * const xdb, const int fd)
     if (!iter1)
       break;
 
-    // 将解码的 WAL 记录插入到内存表
-    struct kv * const kv = malloc(sizeof(struct kv) + wal_kv.kvlen); // 分配 KV 对象内存
-    debug_assert(kv);
-    kv->klen = wal_kv.kref.len;
-    kv->vlen = wal_kv.vlen;
-    kv->hash = kv_crc32c_extend(wal_kv.kref.hash32);
-    memcpy(kv->kv, wal_kv.kref.ptr, wal_kv.kvlen); // 复制键值数据
-    ctx.newkv = kv; // 设置上下文中的新 KV
-    // 合并到内存表
-    bool s = wmt_api->merge(wmt_ref, &wal_kv.kref, xdb_recover_update_func, &ctx);
-    if (!s) // 合并失败则终止
-      debug_die();
-
-    iter = iter1; // 更新迭代器指针到下一条记录
-    nkeys++;
+    if (wal_kv.vlen & WAL_VLEN_BATCH) { // 批量记录：全部恢复或全部丢弃
+      const u8 * const iter2 = xdb_recover_batch(wmt_ref, iter1, end, &wal_kv, &ctx, &nkeys);
+      if (!iter2)
+        break;
+      iter = iter2;
+    } else {
+      xdb_recover_kv(wmt_ref, &wal_kv, &ctx); // 将解码的 WAL 记录插入到内存表
+      iter = iter1; // 更新迭代器指针到下一条记录
+      nkeys++;
+    }
     // 跳过记录间的填充零
     while ((iter < end) && ((*iter) == 0))
       iter++;
   }
 
-  xdb->mtsz = ctx.mtsz; // 更新 XDB 的内存表大小
+  atomic_store_explicit(&xdb->mtsz, ctx.mtsz, MO_RELAXED); // 更新 XDB 的内存表大小
   wmt_api->unref(wmt_ref); // 释放内存表引用
   munmap(mem, fsize); // 解除内存映射
   const u64 rsize = (u64)(iter - mem); // 实际读取和处理的字节数
@@ -823,21 +1005,21 @@ xdb_wal_recover(struct xdb * const xdb)
     ftruncate(wal->fds[1], 0); fdatasync(wal->fds[1]);
     ftruncate(wal->fds[0], 0); fdatasync(wal->fds[0]);
     imt_api->clean(xdb->mt1); // 清理内存表 (mt1)
-    xdb->mtsz = 0; // 重置内存表大小
+    atomic_store_explicit(&xdb->mtsz, 0, MO_RELAXED); // 重置内存表大小
     // 开始一个新的 WAL
     const u64 v1 = msstz_version(xdb->z); // 获取压缩后的新 Zone 版本
     memcpy(wal->buf, &v1, sizeof(v1)); // 在 WAL 缓冲区写入新版本号
     wal->bufoff = sizeof(v1);
     wal->version = v1;
     logger_printf(xdb->logfd, "%s wal comp zv0 %lu zv1 %lu rec %lu %lu mtsz %lu fd0 %d\n",
-        __func__, v0, v1, r1, r0, xdb->mtsz, wal->fds[0]);
+        __func__, v0, v1, r1, r0, (u64)xdb->mtsz, wal->fds[0]);
   } else { // 只有一个有效 WAL 或两个都无效
     const u64 rsize = xdb_recover_fd(xdb, wal->fds[0]); // 尝试从 fds[0] 恢复
     if (rsize == 0) { // 如果 fds[0] 为空或恢复失败，则为新的空 WAL 文件设置版本
       memcpy(wal->buf, &v0, sizeof(v0)); // 使用当前 Zone 版本
       wal->bufoff = sizeof(v0);
       wal->version = v0;
-      logger_printf(xdb->logfd, "%s wal empty v %lu mtsz %lu fd %d\n", __func__, v0, xdb->mtsz, wal->fds[0]);
+      logger_printf(xdb->logfd, "%s wal empty v %lu mtsz %lu fd %d\n", __func__, v0, (u64)xdb->mtsz, wal->fds[0]);
     } else { // 如果成功从 fds[0] 恢复了数据，则重用现有的 WAL
       // 只有一个 WAL 时：WAL 版本应小于等于 Zone 版本
       if (wal->version > v0)
@@ -857,12 +1039,13 @@ xdb_wal_recover(struct xdb * const xdb)
         }
         fdatasync(wal->fds[0]);
       }
-      logger_printf(xdb->logfd, "%s wal rsize %lu woff %lu mtsz %lu fd %d\n", __func__, rsize, wal->woff, xdb->mtsz, wal->fds[0]);
+      logger_printf(xdb->logfd, "%s wal rsize %lu woff %lu mtsz %lu fd %d\n", __func__, rsize, wal->woff, (u64)xdb->mtsz, wal->fds[0]);
     }
     ftruncate(wal->fds[1], 0); // 无论如何都截断第二个 WAL 文件 (fds[1])
     fdatasync(wal->fds[1]);
   }
   wal->soff = wal->woff; // 将同步偏移设置为当前写入偏移
+  wal_unseal(wal); // 恢复完成，允许写者预留 WAL 空间
 }
 // }}} recover // 恢复逻辑区域结束
 
@@ -1061,28 +1244,33 @@ struct xdb_mt_merge_ctx {
 };
 
 // 用于内存表更新的合并函数 (kv_merge_func 的实现)
-// 在持有锁的情况下调用
+// 在持有 WMT 叶节点锁的情况下调用；WAL 预留顺序与同一个键的更新顺序一致
   static struct kv *
 xdb_mt_update_func(struct kv * const kv0, void * const priv)
 {
   struct xdb_mt_merge_ctx * const ctx = priv; // 合并上下文
   struct xdb * const xdb = ctx->xdb;
+  if (unlikely(xdb->mt_view != ctx->mt_view)) // 内存表视图已改变 (例如发生压缩切换)
+    return NULL; // 返回 NULL 表示操作失败，需要重试
+
   const size_t newsz = sst_kv_size(ctx->newkv); // 新 KV 对象的大小
   const size_t oldsz = kv0 ? sst_kv_size(kv0) : 0; // 旧 KV 对象的大小 (如果存在)
   const size_t diffsz = newsz - oldsz; // 大小差异
-
-  xdb_lock(xdb); // 加锁保护共享数据
-  if (unlikely(xdb->mt_view != ctx->mt_view)) { // 检查操作期间内存表视图是否已改变 (例如发生压缩切换)
-    // 如果视图已改变，则中止操作
-    xdb_unlock(xdb);
-    return NULL; // 返回 NULL 表示操作失败，需要重试
+  const u64 estsz = wal_kv_estimate(ctx->newkv);
+  u8 * const ptr = xdb_wal_reserve(xdb, estsz);
+  if (unlikely(ptr == NULL)) // 批量写入正在进行：释放叶节点锁后重试
+    return NULL;
+  // 预留成功后再次检查视图：视图切换与 WAL 切换在封闭状态下一起完成，
+  // 若视图未变，则该记录一定落在与此 WMT 对应的 WAL 中
+  if (unlikely(xdb->mt_view != ctx->mt_view)) {
+    memset(ptr, 0, estsz); // 作废预留空间；恢复时会跳过填充零
+    wal_commit(&xdb->wal, estsz);
+    return NULL;
   }
-  debug_assert(xdb->mtsz >= oldsz);
-  xdb->mtsz += diffsz; // 更新内存表大小
-  xdb->wal.write_user += newsz; // 更新用户写入字节数统计
-  wal_append(&xdb->wal, ctx->newkv); // 将新 KV 追加到 WAL
-
-  xdb_unlock(xdb); // 解锁
+  wal_encode(ptr, ctx->newkv); // 将新 KV 编码到 WAL 缓冲区
+  atomic_fetch_add_explicit(&xdb->mtsz, diffsz, MO_RELAXED); // 更新内存表大小 (必须在提交之前)
+  atomic_fetch_add_explicit(&xdb->wal.write_user, newsz, MO_RELAXED); // 更新用户写入字节数统计
+  wal_commit(&xdb->wal, estsz);
   ctx->success = true; // 标记操作成功
   return ctx->newkv; // 返回新 KV 对象
 }
@@ -1136,12 +1324,217 @@ xdb_del(struct xdb_ref * const ref, const struct kref * const kref)
 xdb_sync(struct xdb_ref * const ref)
 {
   struct xdb * const xdb = ref->xdb;
-  xdb_lock(xdb); // 加锁
+  xdb_wal_lock(xdb); // 加锁并封闭 WAL
   wal_flush_sync_wait(&xdb->wal); // 刷新、同步并等待 WAL 操作完成
-  xdb_unlock(xdb); // 解锁
+  xdb_wal_unlock(xdb); // 开放 WAL 并解锁
 }
 // }}} put del // Put/Delete 操作函数区域结束
 
+// batch {{{ // 批量写入区域开始
+// 创建一个空的批量写入对象
+  struct xdb_batch *
+xdb_batch_create(void)
+{
+  return calloc(1, sizeof(struct xdb_batch));
+}
+
+// 将 kv 追加到批量写入对象并编码它的 WAL 记录 (接管 kv 的所有权)
+  static bool
+xdb_batch_append(struct xdb_batch * const batch, struct kv * const kv)
+{
+  const u64 estsz = wal_kv_estimate(kv);
+  if ((batch->nr == UINT32_MAX) || ((batch->wsize + estsz) > UINT32_MAX)) // 记录体长度以 u32 保存
+    goto fail;
+
+  if (batch->nr == batch->cap) { // 扩展 kvs 数组
+    const u32 cap = batch->cap ? (batch->cap << 1) : 64;
+    struct kv ** const kvs = realloc(batch->kvs, sizeof(kvs[0]) * cap);
+    if (!kvs)
+      goto fail;
+    batch->kvs = kvs;
+    batch->cap = cap;
+  }
+  if ((batch->wsize + estsz) > batch->wcap) { // 扩展 WAL 记录缓冲区
+    u64 wcap = batch->wcap ? batch->wcap : PGSZ;
+    while (wcap < (batch->wsize + estsz))
+      wcap <<= 1;
+    u8 * const wbuf = realloc(batch->wbuf, wcap);
+    if (!wbuf)
+      goto fail;
+    batch->wbuf = wbuf;
+    batch->wcap = wcap;
+  }
+  wal_encode(batch->wbuf + batch->wsize, kv);
+  batch->wsize += estsz;
+  batch->kvs[batch->nr++] = kv;
+  return true;
+
+fail:
+  free(kv);
+  return false;
+}
+
+// 向批量写入对象添加一个插入/更新操作 (复制 kv)
+  bool
+xdb_batch_put(struct xdb_batch * const batch, const struct kv * const kv)
+{
+  struct kv * const newkv = xdb_dup_kv(kv);
+  if (!newkv)
+    return false;
+  return xdb_batch_append(batch, newkv);
+}
+
+// 向批量写入对象添加一个删除操作 (写入删除标记)
+  bool
+xdb_batch_del(struct xdb_batch * const batch, const struct kref * const kref)
+{
+  struct kv * const ts_kv = xdb_new_ts(kref);
+  if (!ts_kv)
+    return false;
+  return xdb_batch_append(batch, ts_kv);
+}
+
+// 清空批量写入对象 (保留已分配的缓冲区以便重用)
+  void
+xdb_batch_clear(struct xdb_batch * const batch)
+{
+  for (u32 i = 0; i < batch->nr; i++)
+    free(batch->kvs[i]);
+  batch->nr = 0;
+  batch->wsize = 0;
+}
+
+// 返回批量写入对象中的操作数量
+  u32
+xdb_batch_count(const struct xdb_batch * const batch)
+{
+  return batch->nr;
+}
+
+// 销毁批量写入对象
+  void
+xdb_batch_destroy(struct xdb_batch * const batch)
+{
+  xdb_batch_clear(batch);
+  free(batch->kvs);
+  free(batch->wbuf);
+  free(batch);
+}
+
+// 按键排序；相同的键按插入顺序排序 (比较 kvs 数组中的位置)
+  static int
+xdb_batch_compare(const void * const p1, const void * const p2)
+{
+  struct kv ** const pp1 = *(struct kv ** const *)p1;
+  struct kv ** const pp2 = *(struct kv ** const *)p2;
+  const int cmp = kv_compare(*pp1, *pp2);
+  if (cmp)
+    return cmp;
+  return (pp1 < pp2) ? -1 : 1;
+}
+
+// 批量写入合并操作的上下文结构体
+struct xdb_batch_merge_ctx {
+  struct kv ** kvs; // 有序且去重的 KV
+  u32 idx;          // 下一个要合并的 KV
+  u64 incsz;        // 内存表大小的变化
+};
+
+// 用于批量写入的合并函数 (kv_merge_func 的实现)
+// wormhole_merge_sorted() 按键的顺序对每个 KV 恰好调用一次
+  static struct kv *
+xdb_batch_merge_func(struct kv * const kv0, void * const priv)
+{
+  struct xdb_batch_merge_ctx * const ctx = priv;
+  struct kv * const kv = ctx->kvs[ctx->idx++];
+  ctx->incsz += sst_kv_size(kv) - (kv0 ? sst_kv_size(kv0) : 0);
+  return kv;
+}
+
+// 原子地写入一个批次：整个批次作为一条记录连续地追加到 WAL，并按键的顺序一次遍历写入 WMT
+// 崩溃恢复时批次要么全部恢复，要么全部丢弃；并发的读者可能看到部分写入的批次
+// 成功后批量写入对象被清空 (KV 的所有权转移给内存表)
+  bool
+xdb_write_batch(struct xdb_ref * const ref, struct xdb_batch * const batch)
+{
+  const u32 nr = batch->nr;
+  if (nr == 0)
+    return true;
+
+  struct kv *** const ptrs = malloc(sizeof(ptrs[0]) * nr);
+  struct kv ** const kvs = malloc(sizeof(kvs[0]) * nr);
+  struct kref * const krefs = malloc(sizeof(krefs[0]) * nr);
+  if (!ptrs || !kvs || !krefs) {
+    free(ptrs);
+    free(kvs);
+    free(krefs);
+    return false;
+  }
+
+  // 批量记录头: 键为操作数量，值为 [记录体长度 u32][记录体的 crc32c u32]，标记为 WAL_VLEN_BATCH
+  u8 hdr[32];
+  u8 * ptr = vi128_encode_u32(hdr, sizeof(u64));
+  ptr = vi128_encode_u32(ptr, WAL_VLEN_BATCH | (sizeof(u32) * 2));
+  const u64 nr64 = nr;
+  const u32 bhdr[3] = {(u32)batch->wsize, kv_crc32c(batch->wbuf, (u32)batch->wsize), kv_crc32c(&nr64, sizeof(nr64))};
+  memcpy(ptr, &nr64, sizeof(nr64));
+  memcpy(ptr + sizeof(nr64), bhdr, sizeof(bhdr)); // 值和键的 crc32c
+  const u64 hsz = (u64)(ptr + sizeof(nr64) + sizeof(bhdr) - hdr);
+
+  // 排序并去重：同一个键只保留最后一次写入 (恢复时按插入顺序重放记录体，结果相同)
+  for (u32 i = 0; i < nr; i++)
+    ptrs[i] = &batch->kvs[i];
+  qsort(ptrs, nr, sizeof(ptrs[0]), xdb_batch_compare);
+  u32 nu = 0;
+  u64 usersz = 0;
+  for (u32 i = 0; i < nr; i++) {
+    struct kv * const kv = *ptrs[i];
+    if (((i + 1) < nr) && kv_match(kv, *ptrs[i + 1])) { // 被同一批次中后面的写入覆盖
+      free(kv);
+      continue;
+    }
+    kvs[nu] = kv;
+    kref_ref_kv(&krefs[nu], kv);
+    usersz += sst_kv_size(kv);
+    nu++;
+  }
+  free(ptrs);
+
+  struct xdb * const xdb = ref->xdb;
+  xdb_write_enter(ref); // 等待写条件满足 (内存表/WAL 未满)
+  while (true) {
+    xdb_ref_update_version(ref);
+    xdb_ref_enter(ref);
+    xdb_lock(xdb);
+    // 持有锁时 WAL 不会切换；视图一致则该批次一定落在与此 WMT 对应的 WAL 中
+    if (xdb->mt_view == ref->mt_view)
+      break;
+    xdb_unlock(xdb);
+    xdb_ref_leave(ref);
+  }
+  // 封闭 WAL 并标记批量写入：单键写者在持有叶节点锁时无法预留，会释放锁并重试
+  struct wal * const wal = &xdb->wal;
+  wal_seal(wal, WAL_SEALED | WAL_BATCH);
+  wal_append_raw(wal, hdr, hsz);
+  wal_append_raw(wal, batch->wbuf, batch->wsize);
+
+  struct xdb_batch_merge_ctx ctx = {.kvs = kvs};
+  if (!wormhole_merge_sorted(ref->wmt_ref, krefs, nu, xdb_batch_merge_func, &ctx))
+    debug_die(); // WAL 已经写入，不能部分失败
+  debug_assert(ctx.idx == nu);
+  atomic_fetch_add_explicit(&xdb->mtsz, ctx.incsz, MO_RELAXED);
+  atomic_fetch_add_explicit(&wal->write_user, usersz, MO_RELAXED);
+  xdb_wal_unlock(xdb);
+  xdb_ref_leave(ref);
+
+  free(kvs);
+  free(krefs);
+  batch->nr = 0; // KV 已交给内存表
+  batch->wsize = 0;
+  return true;
+}
+// }}} batch // 批量写入区域结束
+
 // merge {{{ // Merge (Read-Modify-Write) 操作函数区域开始
 // 获取旧值的辅助函数 (用于 Merge 操作)
 // 调用者需要释放返回的 KV 对象
@@ -1580,6 +1973,58 @@ remixdb_del(struct xdb_ref * const ref, const void * const kbuf, const u32 klen)
   return xdb_update(ref, &kref, ts_kv); // 调用底层更新函数 (写入删除标记)
 }
 
+// 创建批量写入对象
+  struct xdb_batch *
+remixdb_batch_create(void)
+{
+  return xdb_batch_create();
+}
+
+// 向批量写入对象添加插入/更新操作
+  bool
+remixdb_batch_put(struct xdb_batch * const batch, const void * const kbuf, const u32 klen,
+    const void * const vbuf, const u32 vlen)
+{
+  if ((klen + vlen) > 65500) // 与 remixdb_put 相同的长度限制
+    return false;
+
+  struct kv * const newkv = kv_create(kbuf, klen, vbuf, vlen);
+  if (!newkv)
+    return false;
+
+  return xdb_batch_append(batch, newkv);
+}
+
+// 向批量写入对象添加删除操作
+  bool
+remixdb_batch_del(struct xdb_batch * const batch, const void * const kbuf, const u32 klen)
+{
+  struct kref kref;
+  kref_ref_hash32(&kref, kbuf, klen);
+  return xdb_batch_del(batch, &kref);
+}
+
+// 清空批量写入对象
+  void
+remixdb_batch_clear(struct xdb_batch * const batch)
+{
+  xdb_batch_clear(batch);
+}
+
+// 销毁批量写入对象
+  void
+remixdb_batch_destroy(struct xdb_batch * const batch)
+{
+  xdb_batch_destroy(batch);
+}
+
+// 原子地写入一个批次
+  bool
+remixdb_write_batch(struct xdb_ref * const ref, struct xdb_batch * const batch)
+{
+  return xdb_write_batch(ref, batch);
+}
+
 // 测试键是否存在 (在 Wormhole 中，即内存表)
   bool
 remixdb_probe(struct xdb_ref * const ref, const void * const kbuf, const u32 klen)
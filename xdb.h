@@ -16,6 +16,7 @@ extern "C" { // 使用 C 语言链接方式
 struct xdb;
 struct xdb_ref;
 struct xdb_iter;
+struct xdb_batch;
 
 // xdb {{{ // XDB API 定义区域开始
   // 打开一个 XDB 数据库实例
@@ -71,6 +72,37 @@ xdb_del(struct xdb_ref * const ref, const struct kref * const kref);
   extern void
 xdb_sync(struct xdb_ref * const ref);
 
+// 批量写入：一个批次作为一条记录追加到 WAL，并按键的顺序一次遍历写入内存表
+// 崩溃恢复时批次要么全部恢复，要么全部丢弃；并发的读者可能看到部分写入的批次
+// 同一批次中对同一个键的多次写入以最后一次为准
+  // 创建一个空的批量写入对象
+  extern struct xdb_batch *
+xdb_batch_create(void);
+
+  // 向批量写入对象添加一个插入/更新操作 (复制 kv)
+  extern bool
+xdb_batch_put(struct xdb_batch * const batch, const struct kv * const kv);
+
+  // 向批量写入对象添加一个删除操作
+  extern bool
+xdb_batch_del(struct xdb_batch * const batch, const struct kref * const kref);
+
+  // 清空批量写入对象 (丢弃所有操作)
+  extern void
+xdb_batch_clear(struct xdb_batch * const batch);
+
+  // 返回批量写入对象中的操作数量
+  extern u32
+xdb_batch_count(const struct xdb_batch * const batch);
+
+  // 销毁批量写入对象
+  extern void
+xdb_batch_destroy(struct xdb_batch * const batch);
+
+  // 原子地写入一个批次；成功后批量写入对象被清空，可以重用
+  extern bool
+xdb_write_batch(struct xdb_ref * const ref, struct xdb_batch * const batch);
+
 // AKA Atomic Read-Modify-Write (原子读-改-写操作)
 // 由于分配失败，合并操作可能会在未执行任何操作的情况下失败。
 // 由于中止和重试，uf() 可能会被多次调用 (这些不是错误)。
@@ -182,6 +214,31 @@ remixdb_put(struct xdb_ref * const ref, const void * const kbuf, const u32 klen,
   extern bool
 remixdb_del(struct xdb_ref * const ref, const void * const kbuf, const u32 klen);
 
+  // 创建一个批量写入对象
+  extern struct xdb_batch *
+remixdb_batch_create(void);
+
+  // 向批量写入对象添加一个插入/更新操作
+  extern bool
+remixdb_batch_put(struct xdb_batch * const batch, const void * const kbuf, const u32 klen,
+    const void * const vbuf, const u32 vlen);
+
+  // 向批量写入对象添加一个删除操作
+  extern bool
+remixdb_batch_del(struct xdb_batch * const batch, const void * const kbuf, const u32 klen);
+
+  // 清空批量写入对象
+  extern void
+remixdb_batch_clear(struct xdb_batch * const batch);
+
+  // 销毁批量写入对象
+  extern void
+remixdb_batch_destroy(struct xdb_batch * const batch);
+
+  // 原子地写入一个批次 (崩溃恢复时全部恢复或全部丢弃)
+  extern bool
+remixdb_write_batch(struct xdb_ref * const ref, struct xdb_batch * const batch);
+
   // 探测数据库中是否存在指定的键
   extern bool
 remixdb_probe(struct xdb_ref * const ref, const void * const kbuf, const u32 klen);
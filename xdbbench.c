@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2016--2021  Wu, Xingbo <wuxb45@gmail.com>
+ *
+ * All rights reserved. No warranty, explicit or implicit, provided.
+ */
+#define _GNU_SOURCE
+
+#include "ctypes.h"
+#include "lib.h"
+#include "kv.h"
+#include "xdb.h"
+
+// 全局变量定义
+static struct xdb * xdb;       // 数据库实例
+static u64 nkeys = 0;          // 键空间大小 (2 的幂)
+static u64 nops = 0;           // 每个线程的操作数量
+static u32 vlen = 100;         // 值长度
+
+au64 all_seq;                  // 线程序号计数器
+
+/**
+ * 写入工作线程函数
+ * 每个线程对整个键空间执行随机 PUT
+ */
+  static void *
+wscale_worker(void * const ptr)
+{
+  (void)ptr;
+  srandom_u64(time_nsec() + atomic_fetch_add(&all_seq, 1)); // 每个线程使用不同的随机数种子
+  struct xdb_ref * const ref = remixdb_ref(xdb);    // 获取数据库引用
+  const u64 mask = nkeys - 1;
+  u8 ktmp[16];                                       // 键缓冲区
+  u8 * const vtmp = calloc(1, vlen);                // 值缓冲区
+  memset(vtmp, (int)random_u64(), vlen);
+
+  for (u64 i = 0; i < nops; i++) {
+    strhex_64(ktmp, random_u64() & mask);           // 随机键
+    remixdb_put(ref, ktmp, 16, vtmp, vlen);
+  }
+
+  remixdb_unref(ref);
+  free(vtmp);
+  return NULL;
+}
+
+/**
+ * 写者扩展性测试：线程数 1, 2, 4, ..., max
+ * 每一轮所有线程的总吞吐量用于观察写路径 (WAL 组提交) 的扩展性
+ */
+  static void
+bench_wscale(const u32 max_threads)
+{
+  printf("wscale keys %lu ops/thread %lu vlen %u\n", nkeys, nops, vlen);
+  for (u32 nth = 1; nth <= max_threads; nth <<= 1) {
+    all_seq = 0;
+    const u64 dt = thread_fork_join(nth, wscale_worker, false, NULL);
+    const u64 nr = nops * nth;
+    printf("wscale threads %2u put nr %lu mops %.3lf\n", nth, nr, (double)nr / (double)dt * 1e3);
+  }
+}
+
+/**
+ * 主函数 - RemixDB 性能测试程序
+ */
+  int
+main(int argc, char ** argv)
+{
+  if (argc < 5) {
+    printf("Usage: <dirname> <cache-mb> <mt-mb> <bench> ...\n");
+    printf("  wscale <key-power> <ops-power> [<vlen> [<max-threads>]]\n");
+    printf("    writer scaling: 1, 2, 4, ..., max-threads (default 64) threads doing random puts\n");
+    printf("    写者扩展性测试：1, 2, 4, ..., max-threads (默认 64) 个线程执行随机写\n");
+    return 0;
+  }
+
+  const u64 cachesz = a2u64(argv[2]);    // 缓存大小（MB）
+  const u64 mtsz = a2u64(argv[3]);       // 内存表大小（MB）
+  const char * const bench = argv[4];    // 测试名称
+
+  xdb = remixdb_open(argv[1], cachesz, mtsz, true);
+  if (!xdb) {
+    fprintf(stderr, "xdb_open failed\n");
+    return 0;
+  }
+
+  if (!strcmp(bench, "wscale") && argc >= 7) {
+    nkeys = 1lu << a2u64(argv[5]);
+    nops = 1lu << a2u64(argv[6]);
+    if (argc >= 8)
+      vlen = a2u32(argv[7]);
+    const u32 max_threads = (argc >= 9) ? a2u32(argv[8]) : 64;
+    bench_wscale(max_threads);
+  } else {
+    fprintf(stderr, "unknown bench or missing arguments: %s\n", bench);
+  }
+
+  remixdb_close(xdb);
+  return 0;
+}